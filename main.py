@@ -7,13 +7,16 @@ import sys
 sys.path.insert(0, os.path.join(os.path.dirname(__file__), 'src'))
 
 # Now import and run the main module
-from vss_parsing_engine.main import main
+from vss_parsing_engine.main import main, parse_shards, parse_can_databases
 
 if __name__ == "__main__":
     import sys
     
     # Check for --keep-json flag
     keep_json = "--keep-json" in sys.argv
+    per_signal_converters = "--per-signal-converters" in sys.argv
+    shards = parse_shards(sys.argv)
+    can_databases = parse_can_databases(sys.argv)
     
     # Auto-detect the first available VSS file
     vss_file = os.path.join('data', 'input', 'VehicleSignalSpecification.vspec')
@@ -29,7 +32,9 @@ if __name__ == "__main__":
             print("--keep-json flag detected: intermediate JSON file will be preserved")
         from vss_parsing_engine.main import vss_to_json, json_to_vhal, cleanup_intermediate_files
         vss_to_json(vss_file, json_output_file, config_dir)
-        json_to_vhal(json_output_file, vhal_output_dir, templates_dir)
+        json_to_vhal(json_output_file, vhal_output_dir, templates_dir,
+                     per_signal_converters=per_signal_converters, shards=shards,
+                     can_databases=can_databases)
         cleanup_intermediate_files(json_output_file, keep_json=keep_json)
     else:
         print("Error: No VSS file detected. Please place a .vspec file in the 'data/input' directory.")
@@ -0,0 +1,135 @@
+# File: generator/perfect_hash.py
+
+"""
+Minimal perfect hash construction for generated C++ lookup tables.
+
+The generator uses this module to place every key (a VSS path or a VHAL
+property ID) into its own slot of a read-only table at build time, so the
+C++ side can resolve a key with one hash, one displacement lookup and one
+key comparison instead of walking an std::unordered_map.
+
+The hash functions below MUST stay bit-for-bit identical to the ones in
+templates/PerfectHash.h.jinja2.
+"""
+
+MASK64 = 0xFFFFFFFFFFFFFFFF
+
+FNV_OFFSET_BASIS = 0xCBF29CE484222325
+FNV_PRIME = 0x100000001B3
+
+# Average number of keys per displacement bucket. Larger values shrink the
+# seed table at the cost of a slower (build-time only) search.
+DEFAULT_KEYS_PER_BUCKET = 4
+
+MAX_SEED_ATTEMPTS = 1 << 22
+
+
+def mix64(x: int) -> int:
+    """SplitMix64 finalizer."""
+    x &= MASK64
+    x ^= x >> 30
+    x = (x * 0xBF58476D1CE4E5B9) & MASK64
+    x ^= x >> 27
+    x = (x * 0x94D049BB133111EB) & MASK64
+    x ^= x >> 31
+    return x
+
+
+def hash_string(key: str) -> int:
+    """FNV-1a over 8-byte little-endian words, finished with mix64."""
+    data = key.encode('utf-8')
+    h = FNV_OFFSET_BASIS ^ len(data)
+    i = 0
+    n = len(data)
+    while i + 8 <= n:
+        word = int.from_bytes(data[i:i + 8], 'little')
+        h = ((h ^ word) * FNV_PRIME) & MASK64
+        h ^= h >> 29
+        i += 8
+    while i < n:
+        h = ((h ^ data[i]) * FNV_PRIME) & MASK64
+        i += 1
+    return mix64(h)
+
+
+def hash_int(key: int) -> int:
+    """Hash of a 32-bit integer key (e.g. a VHAL property ID)."""
+    return mix64(key & 0xFFFFFFFF)
+
+
+def bucket_of(h: int, num_buckets: int) -> int:
+    return (h >> 32) % num_buckets
+
+
+def slot_of(h: int, seed: int, num_slots: int) -> int:
+    return mix64(h ^ seed) % num_slots
+
+
+class PerfectHash:
+    """Result of a perfect hash build.
+
+    Attributes:
+        seeds: displacement seed per bucket (len(seeds) >= 1)
+        order: order[slot] is the index of the key stored in that slot
+        hashes: full 64-bit hash per key, in input order
+    """
+
+    def __init__(self, seeds, order, hashes):
+        self.seeds = seeds
+        self.order = order
+        self.hashes = hashes
+
+    @property
+    def num_buckets(self):
+        return len(self.seeds)
+
+    @property
+    def num_slots(self):
+        return len(self.order)
+
+
+def build(keys, hash_fn=hash_string, keys_per_bucket=DEFAULT_KEYS_PER_BUCKET):
+    """Build a minimal perfect hash (one slot per key) using hash-and-displace.
+
+    Args:
+        keys: unique, hashable keys
+        hash_fn: hash_string or hash_int
+    Returns:
+        PerfectHash
+    Raises:
+        ValueError: if keys are not unique or no displacement could be found
+    """
+    keys = list(keys)
+    n = len(keys)
+    if len(set(keys)) != n:
+        raise ValueError("perfect hash keys must be unique")
+    if n == 0:
+        return PerfectHash([0], [], [])
+
+    hashes = [hash_fn(k) for k in keys]
+    if len(set(hashes)) != n:
+        raise ValueError("64-bit hash collision between perfect hash keys")
+
+    num_buckets = max(1, (n + keys_per_bucket - 1) // keys_per_bucket)
+    buckets = [[] for _ in range(num_buckets)]
+    for idx, h in enumerate(hashes):
+        buckets[bucket_of(h, num_buckets)].append(idx)
+
+    seeds = [0] * num_buckets
+    order = [-1] * n
+    # Place the largest buckets first while the table is still sparse.
+    for b in sorted(range(num_buckets), key=lambda b: -len(buckets[b])):
+        members = buckets[b]
+        if not members:
+            break
+        for seed in range(MAX_SEED_ATTEMPTS):
+            slots = [slot_of(hashes[i], seed, n) for i in members]
+            if len(set(slots)) == len(slots) and all(order[s] < 0 for s in slots):
+                for i, s in zip(members, slots):
+                    order[s] = i
+                seeds[b] = seed
+                break
+        else:
+            raise ValueError(f"could not place perfect hash bucket {b} ({len(members)} keys)")
+
+    return PerfectHash(seeds, order, hashes)
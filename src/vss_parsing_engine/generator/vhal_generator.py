@@ -1,12 +1,125 @@
 from jinja2 import Environment, FileSystemLoader
 import os
+import re
 import json
 import shutil
+import zlib
+
+from . import perfect_hash
+from ..parsers.dbc_parser import DBCParser
+
+# VHAL types with a dedicated conversion kernel; anything else uses MIXED.
+CONVERSION_KERNEL_TYPES = {'FLOAT', 'INT32', 'INT64', 'BOOLEAN', 'STRING', 'BYTES'}
+
+INT32_MIN = -2**31
+INT32_MAX = 2**31 - 1
+
+# Bit fields of a VehicleProperty ID, as declared in types.hal.jinja2.
+VHAL_PROPERTY_GROUP_BITS = {'SYSTEM': 0x10000000, 'VENDOR': 0x20000000}
+VHAL_PROPERTY_TYPE_BITS = {
+    'STRING': 0x00100000, 'BOOLEAN': 0x00200000, 'INT32': 0x00400000, 'INT32_VEC': 0x00410000,
+    'INT64': 0x00500000, 'INT64_VEC': 0x00510000, 'FLOAT': 0x00600000, 'FLOAT_VEC': 0x00610000,
+    'BYTES': 0x00700000, 'MIXED': 0x00e00000,
+}
+VHAL_AREA_BITS = {
+    'GLOBAL': 0x01000000, 'WINDOW': 0x03000000, 'MIRROR': 0x04000000,
+    'SEAT': 0x05000000, 'DOOR': 0x06000000, 'WHEEL': 0x07000000,
+}
+
+# Area ID used for a property that declares an area but no explicit area configs
+DEFAULT_AREA_IDS = {
+    'WHEEL': 'toInt(VehicleAreaWheel::LEFT_FRONT)',
+    'SEAT': 'toInt(VehicleAreaSeat::ROW_1_LEFT)',
+    'DOOR': 'toInt(VehicleAreaDoor::ROW_1_LEFT)',
+}
+
+# VehicleAreaConfig min/max fields that apply to each VHAL type
+VHAL_RANGE_TYPES = {'INT32': 'INT32', 'INT32_VEC': 'INT32', 'INT64': 'INT64', 'INT64_VEC': 'INT64',
+                    'FLOAT': 'FLOAT', 'FLOAT_VEC': 'FLOAT'}
+
+# Random walks of the simulated sensors. On every period_ticks-th simulator
+# tick a value moves 'smoothing' of the way to a normal sample of mean and
+# stddev, floored at 'floor' (None for no floor).
+SIMULATION_PROFILES = {
+    'SPEED': {'mean': 50.0, 'stddev': 10.0, 'floor': 0.0, 'smoothing': 0.1,
+              'initial': 0.0, 'period_ticks': 1},
+    'TEMPERATURE': {'mean': 22.0, 'stddev': 5.0, 'floor': None, 'smoothing': 0.05,
+                    'initial': 22.0, 'period_ticks': 10},
+}
+
+def _property_id(prop: dict) -> int:
+    """Compute the full VehicleProperty value the way types.hal composes it."""
+    return (int(str(prop['vhal_id_base']), 16)
+            | VHAL_PROPERTY_GROUP_BITS[str(prop['vhal_property_group']).upper()]
+            | VHAL_PROPERTY_TYPE_BITS[str(prop['vhal_type']).upper()]
+            | VHAL_AREA_BITS[str(prop['vhal_area']).upper()])
+
+def _cpp_double(value) -> str:
+    """Format a number as a C++ double literal."""
+    return repr(float(value))
+
+def _shard_of(vss_path: str, num_shards: int) -> int:
+    """Pick the code shard of a signal from the VSS branch it belongs to.
+
+    The branch name is hashed rather than the branches enumerated, so all
+    signals of a branch land in the same shard and adding or removing a
+    branch never moves the others.
+    """
+    branch = vss_path.rpartition('.')[0]
+    return zlib.crc32(branch.encode('utf-8')) % num_shards
+
+def _write_if_changed(output_path: str, content: str) -> bool:
+    """Write a generated file, leaving it untouched if the content is the same.
+
+    Keeping the timestamp of unchanged outputs means the build only
+    recompiles the translation units whose signals actually changed.
+    """
+    if os.path.exists(output_path):
+        with open(output_path, 'r') as f:
+            if f.read() == content:
+                return False
+    os.makedirs(os.path.dirname(output_path), exist_ok=True)
+    with open(output_path, 'w') as f:
+        f.write(content)
+    return True
+
+class _Pool:
+    """Deduplicating pool of generated table entries, addressed by index."""
+
+    def __init__(self):
+        self.items = []
+        self._index = {}
+        self._runs = {}
+
+    def add(self, item) -> int:
+        if item not in self._index:
+            self._index[item] = len(self.items)
+            self.items.append(item)
+        return self._index[item]
+
+    def add_run(self, values: tuple):
+        """Append values as one contiguous run, reusing an identical earlier run."""
+        if values not in self._runs:
+            self._runs[values] = (len(self.items), len(values))
+            self.items.extend(values)
+        return self._runs[values]
 
 class VHALGenerator:
-    def __init__(self, json_file: str, templates_dir: str):
+    def __init__(self, json_file: str, templates_dir: str, per_signal_converters: bool = False,
+                 shards: int = 1, can_databases=None):
         self.json_file = json_file
         self.templates_dir = templates_dir
+        # Emit one conversion function per signal instead of the table-driven
+        # kernels. Much larger output; only meant for debugging a single signal.
+        self.per_signal_converters = per_signal_converters
+        # Number of translation units the per-signal code is split into, so
+        # the build can compile them in parallel (see _shard_of)
+        if shards < 1:
+            raise ValueError(f"Shard count must be at least 1, got {shards}")
+        self.shards = shards
+        # (bus, .dbc file) pairs whose frames VssCanComm decodes directly; the
+        # bus is the branch under Vehicle its signals live in, e.g. CAN_5_Cluster
+        self.can_databases = list(can_databases or [])
         self.jinja_env = Environment(loader=FileSystemLoader(templates_dir))
         self.signals = self.load_signals()
 
@@ -20,16 +133,24 @@ class VHALGenerator:
             'PropertyUtils.h.jinja2': 'impl/PropertyUtils.h',
             'PropertyUtils.cpp.jinja2': 'src/PropertyUtils.cpp',
             'Android.bp.jinja2': 'Android.bp',
-            'VehicleService.cpp.jinja2': 'src/VehicleService.cpp'
+            'VehicleService.cpp.jinja2': 'src/VehicleService.cpp',
+            'PerfectHash.h.jinja2': 'impl/PerfectHash.h',
+            'PropertyIndex.h.jinja2': 'impl/PropertyIndex.h'
         }
 
         # Manual implementation templates (now treated as Jinja2 templates)
         self.manual_templates = {
             'DefaultVehicleHal.h.jinja2': 'impl/DefaultVehicleHal.h',
             'DefaultVehicleHal.cpp.jinja2': 'src/DefaultVehicleHal.cpp',
-            'MockSensor.h.jinja2': 'impl/MockSensor.h',
             'MockActuator.h.jinja2': 'impl/MockActuator.h',
-            'SubscriptionManager.h.jinja2': 'impl/SubscriptionManager.h'
+            'SubscriptionManager.h.jinja2': 'impl/SubscriptionManager.h',
+            'DefaultVehicleHalShards.h.jinja2': 'impl/DefaultVehicleHalShards.h'
+        }
+
+        # Per-signal templates, rendered once per shard with only the signals of
+        # that shard; '{shard}' in the output name is the shard number
+        self.manual_shard_templates = {
+            'DefaultVehicleHalShard.cpp.jinja2': 'src/DefaultVehicleHalShard{shard}.cpp'
         }
         
         # VSS Converter files (new dynamic conversion system)
@@ -40,12 +161,61 @@ class VHALGenerator:
             'VssCommConn.cpp.jinja2': 'src/VssCommConn.cpp',
             'VssSocketComm.h.jinja2': 'impl/VssSocketComm.h',
             'VssSocketComm.cpp.jinja2': 'src/VssSocketComm.cpp',
+            'VssLineBuffer.h.jinja2': 'impl/VssLineBuffer.h',
+            'VssLineBuffer.cpp.jinja2': 'src/VssLineBuffer.cpp',
+            'VssIngestQueue.h.jinja2': 'impl/VssIngestQueue.h',
+            'VssIngestQueue.cpp.jinja2': 'src/VssIngestQueue.cpp',
+            'VssIngestPipeline.h.jinja2': 'impl/VssIngestPipeline.h',
+            'VssIngestPipeline.cpp.jinja2': 'src/VssIngestPipeline.cpp',
+            'VssConflator.h.jinja2': 'impl/VssConflator.h',
+            'VssConflator.cpp.jinja2': 'src/VssConflator.cpp',
             'AndroidVssConverter.h.jinja2': 'impl/AndroidVssConverter.h',
             'AndroidVssConverter.cpp.jinja2': 'src/AndroidVssConverter.cpp',
             'ConverterUtils.h.jinja2': 'impl/ConverterUtils.h',
-            'ConverterUtils.cpp.jinja2': 'src/ConverterUtils.cpp'
+            'ConverterUtils.cpp.jinja2': 'src/ConverterUtils.cpp',
+            'VssLog.h.jinja2': 'impl/VssLog.h',
+            'VssLog.cpp.jinja2': 'src/VssLog.cpp',
+            'VssMetrics.h.jinja2': 'impl/VssMetrics.h',
+            'VssMetrics.cpp.jinja2': 'src/VssMetrics.cpp',
+            'VssTrafficLog.h.jinja2': 'impl/VssTrafficLog.h',
+            'VssTrafficLog.cpp.jinja2': 'src/VssTrafficLog.cpp',
+            'VssReplayComm.h.jinja2': 'impl/VssReplayComm.h',
+            'VssReplayComm.cpp.jinja2': 'src/VssReplayComm.cpp',
+            'VssChangeFilter.h.jinja2': 'impl/VssChangeFilter.h',
+            'VssChangeFilter.cpp.jinja2': 'src/VssChangeFilter.cpp',
+            'VssShmRing.h.jinja2': 'impl/VssShmRing.h',
+            'VssShmRing.cpp.jinja2': 'src/VssShmRing.cpp',
+            'VssShmComm.h.jinja2': 'impl/VssShmComm.h',
+            'VssShmComm.cpp.jinja2': 'src/VssShmComm.cpp',
+            'VssWireFormat.h.jinja2': 'impl/VssWireFormat.h',
+            'VssWireDecoder.h.jinja2': 'impl/VssWireDecoder.h',
+            'VssWireDecoder.cpp.jinja2': 'src/VssWireDecoder.cpp',
+            'VssPropValuePool.h.jinja2': 'impl/VssPropValuePool.h',
+            'VssPropValuePool.cpp.jinja2': 'src/VssPropValuePool.cpp',
+            'VssThreadPolicy.h.jinja2': 'impl/VssThreadPolicy.h',
+            'VssThreadPolicy.cpp.jinja2': 'src/VssThreadPolicy.cpp',
+            'VssSimulator.h.jinja2': 'impl/VssSimulator.h',
+            'VssSimulator.cpp.jinja2': 'src/VssSimulator.cpp',
+            'VssCanDecoder.h.jinja2': 'impl/VssCanDecoder.h',
+            'VssCanDecoder.cpp.jinja2': 'src/VssCanDecoder.cpp',
+            'VssCanComm.h.jinja2': 'impl/VssCanComm.h',
+            'VssCanComm.cpp.jinja2': 'src/VssCanComm.cpp',
+            'VssConverterBenchmark.cpp.jinja2': 'src/VssConverterBenchmark.cpp'
         }
 
+        # Converter sources that need the device-side VehicleEmulator; the rest
+        # also build for the host. The benchmark is its own target.
+        self.vss_converter_device_sources = {'src/VssVehicleEmulator.cpp', 'src/VssCommConn.cpp',
+                                             'src/VssSocketComm.cpp', 'src/VssReplayComm.cpp',
+                                             'src/VssShmComm.cpp', 'src/VssCanComm.cpp'}
+        self.vss_converter_benchmark_source = 'src/VssConverterBenchmark.cpp'
+
+        # The table-driven converter has no per-signal code to shard
+        self.vss_converter_shard_files = {}
+        if self.per_signal_converters:
+            self.vss_converter_files['AndroidVssConverterShards.h.jinja2'] = 'impl/AndroidVssConverterShards.h'
+            self.vss_converter_shard_files['AndroidVssConverterShard.cpp.jinja2'] = 'src/AndroidVssConverterShard{shard}.cpp'
+
     def load_signals(self):
         """Load signals from JSON file"""
         with open(self.json_file, 'r') as f:
@@ -114,6 +284,139 @@ class VHALGenerator:
         
         return properties
 
+    def _build_property_index(self, properties):
+        """Lay out the distinct property IDs in perfect-hash slot order.
+
+        Several VSS signals can compose the same ID; they share one slot, so
+        only the first property with a given ID is kept, with the combined
+        access of all of them.
+        """
+        unique = {}
+        for prop in properties:
+            access = str(prop['vhal_access']).upper()
+            entry = unique.setdefault(_property_id(prop), {**prop, 'slot_readable': False,
+                                                          'slot_writable': False})
+            # A shared slot is readable/writable if any of its properties is
+            entry['slot_readable'] |= access in ('READ', 'READ_WRITE')
+            entry['slot_writable'] |= access in ('WRITE', 'READ_WRITE')
+        ids = list(unique.keys())
+        id_hash = perfect_hash.build(ids, hash_fn=perfect_hash.hash_int)
+        print(f"Built property ID perfect hash: {id_hash.num_slots} slots, "
+              f"{id_hash.num_buckets} buckets ({len(properties) - len(ids)} shared IDs)")
+        return {
+            'property_index_slots': [unique[ids[i]] for i in id_hash.order],
+            'property_index_seeds': id_hash.seeds,
+        }
+
+    def _build_property_names(self, properties, property_index_slots):
+        """Lay out the property name tables used by PropertyUtils.cpp.
+
+        Names are stored once, concatenated in name perfect-hash slot order,
+        which gives name -> ID lookup. ID -> name goes through the property
+        index: each ID slot points at the name slot of its first property.
+        """
+        names = [prop['vhal_id'] for prop in properties]
+        name_hash = perfect_hash.build(names)
+        print(f"Built property name perfect hash: {name_hash.num_slots} slots, "
+              f"{name_hash.num_buckets} buckets")
+
+        name_slots = []
+        name_slot_of = {}
+        offset = 0
+        for slot, i in enumerate(name_hash.order):
+            name_slots.append({'name': names[i], 'offset': offset, 'length': len(names[i])})
+            name_slot_of[names[i]] = slot
+            offset += len(names[i])
+        return {
+            'property_name_slots': name_slots,
+            'property_name_seeds': name_hash.seeds,
+            'property_name_data_size': offset,
+            # Slots whose lookup is checked at compile time against the generator's hash
+            'property_name_check_slots': sorted({0, len(name_slots) // 2, len(name_slots) - 1})
+                                         if name_slots else [],
+            'property_index_name_slots': [name_slot_of[prop['vhal_id']] for prop in property_index_slots],
+        }
+
+    def _build_default_config(self, properties):
+        """Encode the DefaultConfig.h property table as compact pools.
+
+        Each property becomes a fixed-size entry with indexes into shared pools
+        (sample rates, area config lists, config arrays, initial values); equal
+        pool entries are stored once. DefaultConfig.h expands an entry to a
+        VehiclePropConfig only when it is registered.
+        """
+        pools = {name: _Pool() for name in ('sample_rates', 'area_config_sets', 'config_arrays',
+                                            'initial_values', 'area_configs', 'int32', 'int64',
+                                            'float', 'string')}
+
+        def run(pool, values):
+            """Store a list of values contiguously, returning (begin, count)."""
+            values = tuple(values)
+            return pools[pool].add_run(values) if values else (0, 0)
+
+        entries = []
+        for prop in properties:
+            vhal_type = str(prop['vhal_type']).upper()
+            change_mode = str(prop['vhal_change_mode']).upper()
+            entry = {'prop': prop, 'sample_rates': None, 'area_configs': None,
+                     'config_array': None}
+
+            if change_mode == 'CONTINUOUS':
+                entry['sample_rates'] = pools['sample_rates'].add(
+                    (_cpp_double(prop.get('min_sample_rate') or 0.0) + 'f',
+                     _cpp_double(prop.get('max_sample_rate') or 10.0) + 'f'))
+
+            range_type = VHAL_RANGE_TYPES.get(vhal_type, 'NONE')
+
+            def area_config(area_id, min_value, max_value):
+                """CompactAreaConfig initializer fields, as C++ literals."""
+                return (area_id, range_type,
+                        'false' if min_value is None else 'true',
+                        'false' if max_value is None else 'true',
+                        _cpp_double(0.0 if min_value is None else min_value),
+                        _cpp_double(0.0 if max_value is None else max_value))
+
+            area_configs = [area_config(str(area['area_id']), area.get('min_value'), area.get('max_value'))
+                            for area in (prop.get('area_configs') or [])]
+            area = str(prop['vhal_area']).upper()
+            if not area_configs and area != 'GLOBAL':
+                area_configs = [area_config(DEFAULT_AREA_IDS.get(area, f"toInt(VehicleArea::{area})"),
+                                            prop.get('min_value'), prop.get('max_value'))]
+            if area_configs:
+                entry['area_configs'] = pools['area_config_sets'].add(run('area_configs', area_configs))
+
+            if prop.get('config_array'):
+                entry['config_array'] = pools['config_arrays'].add(
+                    run('int32', (int(item) for item in prop['config_array'])))
+
+            initial = prop.get('initial_value')
+            if vhal_type in ('BOOLEAN', 'INT32'):
+                value = ('INT32', run('int32', [int(initial or 0)]))
+            elif vhal_type == 'INT64':
+                value = ('INT64', run('int64', [int(initial or 0)]))
+            elif vhal_type == 'FLOAT':
+                value = ('FLOAT', run('float', [_cpp_double(initial or 0.0) + 'f']))
+            elif vhal_type == 'STRING':
+                literal = str(initial or '').replace('\\', '\\\\').replace('"', '\\"')
+                value = ('STRING', (pools['string'].add(literal), 1))
+            elif vhal_type == 'INT32_VEC':
+                value = ('INT32', run('int32', (int(v) for v in initial or [])))
+            elif vhal_type == 'FLOAT_VEC':
+                value = ('FLOAT', run('float', (_cpp_double(v) + 'f' for v in initial or [])))
+            else:
+                value = ('NONE', (0, 0))
+            entry['initial_value'] = pools['initial_values'].add(value)
+            entries.append(entry)
+
+        for name, pool in pools.items():
+            if len(pool.items) >= 0xFFFF:
+                raise ValueError(f"DefaultConfig {name} pool has {len(pool.items)} entries, "
+                                 "more than its 16-bit index can address")
+        print(f"Encoded {len(entries)} property configs: "
+              + ", ".join(f"{len(pool.items)} {name}" for name, pool in pools.items()))
+        return {'config_entries': entries,
+                **{f'config_{name}_pool': pool.items for name, pool in pools.items()}}
+
     def _copy_static_files(self, output_dir: str):
         """Copy static AOSP files that should not be generated"""
         if not os.path.exists(self.static_files_dir):
@@ -146,9 +449,7 @@ class VHALGenerator:
             try:
                 template = self.jinja_env.get_template(f'manual/{template_name}')
                 content = template.render(context)
-                os.makedirs(os.path.dirname(output_path), exist_ok=True)
-                with open(output_path, 'w') as f:
-                    f.write(content)
+                _write_if_changed(output_path, content)
                 print(f"Generated enhanced manual implementation: {output_filename}")
             except Exception as e:
                 print(f"Warning: Could not generate {template_name}: {e}")
@@ -158,6 +459,49 @@ class VHALGenerator:
                 if os.path.exists(template_path):
                     shutil.copy2(template_path, output_path)
                     print(f"Copied static template: {output_filename}")
+
+        self._generate_shard_files(output_dir, 'manual', self.manual_shard_templates,
+                                   context, context['properties'], 'path')
+
+    def _converter_sources(self):
+        """List the generated converter sources for Android.bp, split into host and device-only"""
+        sources = [name for name in self.vss_converter_files.values()
+                   if name.startswith('src/') and name != self.vss_converter_benchmark_source]
+        sources += [pattern.format(shard=shard) for pattern in self.vss_converter_shard_files.values()
+                    for shard in range(self.shards)]
+        host = [os.path.basename(name) for name in sources if name not in self.vss_converter_device_sources]
+        device = [os.path.basename(name) for name in sources if name in self.vss_converter_device_sources]
+        return {'converter_sources': host, 'converter_device_sources': device,
+                'converter_benchmark_source': os.path.basename(self.vss_converter_benchmark_source)}
+
+    def _shard_sources(self):
+        """List the generated shard sources, for Android.bp"""
+        patterns = list(self.manual_shard_templates.values()) + list(self.vss_converter_shard_files.values())
+        return [os.path.basename(pattern.format(shard=shard))
+                for pattern in patterns for shard in range(self.shards)]
+
+    def _generate_shard_files(self, output_dir: str, template_dir: str, shard_templates: dict,
+                              context: dict, items: list, path_key: str):
+        """Render each per-signal template once per shard.
+
+        Each shard sees its own signals as 'shard_items', in their original order.
+        Unchanged shards are not rewritten, so editing one VSS branch only
+        rebuilds the shard that holds it.
+        """
+        shard_items = [[] for _ in range(self.shards)]
+        for item in items:
+            shard_items[_shard_of(item[path_key], self.shards)].append(item)
+
+        for template_name, output_pattern in shard_templates.items():
+            template = self.jinja_env.get_template(f'{template_dir}/{template_name}')
+            written = 0
+            for shard, items_in_shard in enumerate(shard_items):
+                content = template.render({**context, 'shard': shard, 'shard_items': items_in_shard})
+                output_path = os.path.join(output_dir, output_pattern.format(shard=shard))
+                written += _write_if_changed(output_path, content)
+            sizes = [len(items_in_shard) for items_in_shard in shard_items]
+            print(f"Generated {self.shards} shards of {template_name} "
+                  f"({min(sizes)}-{max(sizes)} signals each, {written} rewritten)")
     
     def _extract_conversion_data(self):
         """Extract VSS to VHAL conversion data for dynamic converter generation"""
@@ -171,8 +515,11 @@ class VHALGenerator:
                 signal.get('node_type', '') not in ['branch'] and
                 signal.get('datatype') and signal.get('vhal_type')):
                 
+                vss_path = signal.get('path', path_or_idx if isinstance(path_or_idx, str) else '')
                 conversion_data = {
-                    'vss_path': signal.get('path', path_or_idx if isinstance(path_or_idx, str) else ''),
+                    'vss_path': vss_path,
+                    'converter_name': 'convert' + vss_path.replace('.', '_').replace('[', '_').replace(']', '_'),
+                    'vhal_id': signal.get('vhal_id', ''),
                     'vhal_property_id': signal.get('vhal_id_base', ''),
                     'vss_datatype': signal.get('datatype', ''),
                     'vhal_type': signal.get('vhal_type', 'MIXED'),
@@ -185,22 +532,286 @@ class VHALGenerator:
                     'vhal_access': signal.get('vhal_access', 'READ'),
                     'vhal_area': signal.get('vhal_area', 'GLOBAL'),
                     'vhal_change_mode': signal.get('vhal_change_mode', 'ON_CHANGE'),
+                    'max_sample_rate': signal.get('max_sample_rate'),
                     'description': signal.get('description', '')
                 }
+                conversion_data.update(self._conversion_descriptor(conversion_data))
                 conversion_mappings.append(conversion_data)
         
         print(f"Generated {len(conversion_mappings)} VSS to VHAL conversion mappings")
         return conversion_mappings
     
+    def _conversion_descriptor(self, mapping: dict) -> dict:
+        """Derive the VssSignalDescriptor fields (as C++ literals) for a mapping.
+
+        Clamping only applies to FLOAT and INT32 signals; INT32 bounds are
+        limited to, and default to, the int32 range so the clamped value can
+        always be cast back safely. The sample rate falls back to the same
+        10 Hz default DefaultConfig.h uses.
+        """
+        vhal_type = mapping['vhal_type'] if mapping['vhal_type'] in CONVERSION_KERNEL_TYPES else 'MIXED'
+        min_value = mapping['min_value'] if vhal_type in ('FLOAT', 'INT32') else None
+        max_value = mapping['max_value'] if vhal_type in ('FLOAT', 'INT32') else None
+        if vhal_type == 'INT32':
+            # Unbounded INT32 signals still clamp to the int32 range
+            min_value = INT32_MIN if min_value is None else min(max(int(min_value), INT32_MIN), INT32_MAX)
+            max_value = INT32_MAX if max_value is None else min(max(int(max_value), INT32_MIN), INT32_MAX)
+        return {
+            'kernel_type': vhal_type,
+            'clamp_min': _cpp_double(min_value) if min_value is not None else '-kUnbounded',
+            'clamp_max': _cpp_double(max_value) if max_value is not None else 'kUnbounded',
+            'multiplier': _cpp_double(mapping['unit_multiplier'] if mapping['unit_multiplier'] is not None else 1.0),
+            'offset': _cpp_double(mapping['unit_offset'] if mapping['unit_offset'] is not None else 0.0),
+            'change_mode': str(mapping['vhal_change_mode']).upper(),
+            'max_sample_rate': _cpp_double(mapping['max_sample_rate'] if mapping['max_sample_rate'] is not None else 10.0) + 'f',
+        }
+
+    def _build_simulation(self, property_index_slots):
+        """Give every readable property with a simulated sensor a simulator lane.
+
+        Speed and velocity properties walk like a speed, temperatures like a
+        temperature and any other CONTINUOUS property like a speed. Lanes are
+        grouped by profile, so that each group advances as one contiguous run.
+        """
+        members = {profile: [] for profile in SIMULATION_PROFILES}
+        for slot, prop in enumerate(property_index_slots):
+            if not prop['slot_readable']:
+                continue
+            name = prop['name'].lower()
+            if 'speed' in name or 'velocity' in name:
+                profile = 'SPEED'
+            elif 'temp' in name:
+                profile = 'TEMPERATURE'
+            elif str(prop['vhal_change_mode']).upper() == 'CONTINUOUS':
+                profile = 'SPEED'
+            else:
+                continue
+            members[profile].append({'slot': slot, 'name': prop['name'], 'vhal_id': prop['vhal_id']})
+
+        lanes = []
+        groups = []
+        for profile, group_lanes in members.items():
+            if not group_lanes:
+                continue
+            params = SIMULATION_PROFILES[profile]
+            floor = params['floor']
+            groups.append({
+                'profile': profile, 'begin': len(lanes), 'end': len(lanes) + len(group_lanes),
+                'period_ticks': params['period_ticks'],
+                'mean': _cpp_double(params['mean']) + 'f',
+                'stddev': _cpp_double(params['stddev']) + 'f',
+                'floor': _cpp_double(floor) + 'f' if floor is not None
+                         else '-std::numeric_limits<float>::infinity()',
+                'smoothing': _cpp_double(params['smoothing']) + 'f',
+                'initial': _cpp_double(params['initial']) + 'f',
+            })
+            lanes += group_lanes
+        print(f"Simulating {len(lanes)} properties in {len(groups)} groups")
+        return {'simulation_lanes': lanes, 'simulation_groups': groups}
+
+    def _build_benchmark_signals(self, conversion_mappings):
+        """Pick a representative raw value for every mapping, for the benchmark.
+
+        The value lies inside the signal's bounds so it converts without
+        clamping. Bounded numeric signals also get a clamp value just outside
+        their range that still parses as the signal's type; it is empty when
+        the bounds leave no such value.
+        """
+        signals = []
+        for mapping in conversion_mappings:
+            kind = mapping['kernel_type']
+            min_value = mapping['min_value']
+            max_value = mapping['max_value']
+            clamp_value = ''
+            if kind in ('INT32', 'INT64', 'FLOAT'):
+                low = min_value if min_value is not None else 0
+                high = max_value if max_value is not None else low + 100
+                if high < low:
+                    high = low
+                if kind == 'FLOAT':
+                    value = repr((float(low) + float(high)) / 2)
+                    if max_value is not None:
+                        clamp_value = repr(float(max_value) + abs(float(max_value)) + 1.0)
+                else:
+                    limit_min = INT32_MIN if kind == 'INT32' else -2**63
+                    limit_max = INT32_MAX if kind == 'INT32' else 2**63 - 1
+                    low = min(max(int(low), limit_min), limit_max)
+                    high = min(max(int(high), limit_min), limit_max)
+                    value = str((low + high) // 2)
+                    # INT64 is not clamped by the converter
+                    if kind == 'INT32':
+                        if max_value is not None and high < limit_max:
+                            clamp_value = str(high + 1)
+                        elif min_value is not None and low > limit_min:
+                            clamp_value = str(low - 1)
+            elif kind == 'BOOLEAN':
+                value = 'true'
+            elif kind == 'BYTES':
+                value = '0x0102030405060708'
+            else:
+                value = 'benchmark'
+            signals.append({'path': mapping['vss_path'], 'kind': kind, 'value': value,
+                            'clamp_value': clamp_value})
+        return signals
+
+    def _build_wire_signals(self, conversion_slots):
+        """Number the signals for the binary wire protocol.
+
+        Indices follow the sorted VSS paths rather than the perfect-hash slots,
+        so they only move when signals are added or removed, not when the hash
+        seeds change. The schema hash covers every index, path and type, so a
+        producer built against another VSS file is refused at the hello.
+        """
+        slot_of = {mapping['vss_path']: slot for slot, mapping in enumerate(conversion_slots)}
+        signals = []
+        names = set()
+        schema_hash = 0x811c9dc5
+        for index, path in enumerate(sorted(slot_of)):
+            mapping = conversion_slots[slot_of[path]]
+            name = '_'.join(re.sub(r'(?<=[a-z0-9])(?=[A-Z])', '_', part)
+                            for part in re.split(r'[^A-Za-z0-9]+', path) if part).upper()
+            if name in names:
+                name = f'{name}_{index}'
+            names.add(name)
+            signals.append({'index': index, 'path': path, 'slot': slot_of[path], 'name': name,
+                            'kernel_type': mapping['kernel_type']})
+            for byte in f"{index}:{path}:{mapping['kernel_type']}\n".encode('utf-8'):
+                schema_hash = ((schema_hash ^ byte) * 0x01000193) & 0xffffffff
+        if len(signals) > 0xffff:
+            raise ValueError("The binary wire protocol indexes at most 65535 signals")
+        return signals, f'0x{schema_hash:08x}'
+
+    def _build_can_decoders(self, wire_signals):
+        """Lay out the SocketCAN decoder tables from the configured CAN databases.
+
+        A DBC signal S of message M on bus B feeds the VSS signal
+        Vehicle.B.M_MSG_On_B.S (or Vehicle.B.M_On_B.S for messages already
+        named MSG_<n>). Every signal's bit position is reduced to a shift and
+        mask of the frame loaded as one 64-bit word, little-endian for Intel
+        and big-endian for Motorola byte order, so decoding needs no per-bit
+        work. Signals without a VSS counterpart are left out.
+        """
+        index_of = {signal['path']: signal for signal in wire_signals}
+        buses, messages, signals = [], [], []
+        skipped = 0
+        for bus, dbc_file in self.can_databases:
+            bus_index = len(buses)
+            buses.append(bus)
+            for message in DBCParser(dbc_file).load_messages():
+                if message['length'] > 8:
+                    print(f"  ⚠ Skipping CAN FD message {message['name']}: only classic frames are decoded")
+                    continue
+                prefixes = [f"Vehicle.{bus}.{message['name']}_MSG_On_{bus}.",
+                            f"Vehicle.{bus}.{message['name']}_On_{bus}."]
+                decoded = []
+                for signal in message['signals']:
+                    wire = next((index_of[p + signal['name']] for p in prefixes
+                                 if p + signal['name'] in index_of), None)
+                    if wire is None:
+                        continue
+                    layout = self._can_signal_layout(signal, wire)
+                    if layout is None:
+                        skipped += 1
+                        continue
+                    decoded.append(layout)
+                if decoded:
+                    messages.append({'bus': bus_index, 'id': message['id'],
+                                     'id_hex': f"0x{message['id']:08x}",
+                                     'length': message['length'], 'first': len(signals),
+                                     'count': len(decoded), 'name': message['name']})
+                    signals.extend(decoded)
+        messages.sort(key=lambda m: (m['bus'], m['id']))
+        if len({(m['bus'], m['id']) for m in messages}) != len(messages):
+            raise ValueError("CAN databases declare the same frame ID twice on one bus")
+        if self.can_databases:
+            print(f"  ✓ CAN decoders: {len(messages)} frames, {len(signals)} signals"
+                  f" ({skipped} unsupported signals skipped)")
+        return buses, messages, signals
+
+    @staticmethod
+    def _can_signal_layout(signal, wire):
+        """Reduce a DBC signal to its shift, mask and flags, or None if unsupported."""
+        length = signal['length']
+        if signal['multiplexed'] or length < 1 or length > 64:
+            return None
+        start = signal['start_bit']
+        if signal['little_endian']:
+            shift = start
+            if shift + length > 64:
+                return None
+        else:
+            # Motorola start bits name the MSB; byte 0 is the top of the big-endian word
+            msb = (7 - start // 8) * 8 + start % 8
+            shift = msb - length + 1
+            if shift < 0:
+                return None
+        kernel_type = wire['kernel_type']
+        if kernel_type == 'BOOLEAN':
+            wire_type = 'BOOL'
+        elif kernel_type in ('INT32', 'INT64'):
+            wire_type = 'INT64'
+        elif kernel_type in ('FLOAT', 'MIXED'):
+            wire_type = 'DOUBLE'
+        else:
+            return None
+        flags = []
+        if not signal['little_endian']:
+            flags.append('CAN_BIG_ENDIAN')
+        if signal['signed']:
+            flags.append('CAN_SIGNED')
+        if signal['factor'] != 1.0 or signal['offset'] != 0.0:
+            flags.append('CAN_SCALED')
+        return {'index': wire['index'], 'name': wire['name'], 'shift': shift,
+                'mask': f"0x{(1 << length) - 1:x}", 'length': length,
+                'flags': ' | '.join(flags) if flags else '0', 'wire_type': wire_type,
+                'factor': _cpp_double(signal['factor']), 'offset': _cpp_double(signal['offset'])}
+
     def _generate_vss_converter_files(self, output_dir: str, context: dict):
         """Generate VSS converter system files"""
         print("\nGenerating VSS converter system...")
         
         # Extract conversion data for the converter
         conversion_mappings = self._extract_conversion_data()
+
+        # Lay the mappings out in perfect-hash slot order so the converter can
+        # resolve a VSS path without building any map at runtime.
+        path_hash = perfect_hash.build(m['vss_path'] for m in conversion_mappings)
+        print(f"Built VSS path perfect hash: {path_hash.num_slots} slots, {path_hash.num_buckets} buckets")
+
+        conversion_slots = [conversion_mappings[i] for i in path_hash.order]
+
+        # All slot paths go into one character array addressed by offset, so the
+        # path table holds no pointers and needs no relocations at load time
+        path_refs = []
+        path_data_size = 0
+        for mapping in conversion_slots:
+            path_refs.append({'offset': path_data_size, 'length': len(mapping['vss_path'])})
+            path_data_size += len(mapping['vss_path'])
+        if any(c in m['vss_path'] for m in conversion_slots for c in '"\\'):
+            raise ValueError("VSS paths must not contain quotes or backslashes")
+
+        wire_signals, wire_schema_hash = self._build_wire_signals(conversion_slots)
+        can_buses, can_messages, can_signals = self._build_can_decoders(wire_signals)
+
         converter_context = {
             **context,
             'conversion_mappings': conversion_mappings,
+            'conversion_slots': conversion_slots,
+            'conversion_hash_seeds': path_hash.seeds,
+            'conversion_path_refs': path_refs,
+            'conversion_path_data_size': path_data_size,
+            # Slots whose lookup is checked at compile time against the generator's hash
+            'conversion_check_slots': sorted({0, len(conversion_slots) // 2, len(conversion_slots) - 1})
+                                      if conversion_slots else [],
+            'per_signal_converters': self.per_signal_converters,
+            'benchmark_signals': self._build_benchmark_signals(conversion_mappings),
+            **self._build_simulation(context['property_index_slots']),
+            'wire_signals': wire_signals,
+            'wire_schema_hash': wire_schema_hash,
+            'can_buses': can_buses,
+            'can_messages': can_messages,
+            'can_signals': can_signals,
+            'can_max_frame_signals': max((m['count'] for m in can_messages), default=0),
             'total_signals': len(conversion_mappings)
         }
         
@@ -209,28 +820,33 @@ class VHALGenerator:
             try:
                 template = self.jinja_env.get_template(f'vss_converter/{template_name}')
                 content = template.render(converter_context)
-                os.makedirs(os.path.dirname(output_path), exist_ok=True)
-                with open(output_path, 'w') as f:
-                    f.write(content)
+                _write_if_changed(output_path, content)
                 print(f"Generated VSS converter: {output_filename}")
             except Exception as e:
                 print(f"Warning: Could not generate VSS converter {template_name}: {e}")
 
+        self._generate_shard_files(output_dir, 'vss_converter', self.vss_converter_shard_files,
+                                   converter_context, conversion_mappings, 'vss_path')
+
     def generate_vhal_files(self, output_dir: str):
         """Generate VHAL files including the VSS converter system"""
         print("\nGenerating VHAL files...")
         os.makedirs(output_dir, exist_ok=True)
         properties = self._extract_property_data()
-        context = {'properties': properties, 'vss_file_path': self.json_file}
+        property_index = self._build_property_index(properties)
+        context = {'properties': properties, 'vss_file_path': self.json_file,
+                   'num_shards': self.shards, 'shard_sources': self._shard_sources(),
+                   **self._converter_sources(),
+                   **property_index,
+                   **self._build_property_names(properties, property_index['property_index_slots']),
+                   **self._build_default_config(properties)}
 
         # Generate core VHAL files
         for template_name, output_name in self.generated_files.items():
             template = self.jinja_env.get_template(template_name)
             content = template.render(context)
             output_path = os.path.join(output_dir, output_name)
-            os.makedirs(os.path.dirname(output_path), exist_ok=True)
-            with open(output_path, 'w') as f:
-                f.write(content)
+            _write_if_changed(output_path, content)
             print(f"Generated {output_name}")
 
         # Generate VSS converter system
@@ -90,12 +90,15 @@ def vss_to_json(vss_file: str, json_output_file: str, config_dir: str):
         print(f"Error during VSS to JSON conversion: {e}")
         sys.exit(1)
 
-def json_to_vhal(json_file: str, output_dir: str, templates_dir: str):
+def json_to_vhal(json_file: str, output_dir: str, templates_dir: str,
+                 per_signal_converters: bool = False, shards: int = 1, can_databases=None):
     """Generate VHAL structure from JSON"""
     print("\nStep 2: Generating VHAL structure from JSON...")
     
     try:
-        vhal_generator = VHALGenerator(json_file, templates_dir)
+        vhal_generator = VHALGenerator(json_file, templates_dir,
+                                       per_signal_converters=per_signal_converters,
+                                       shards=shards, can_databases=can_databases)
         vhal_generator.generate_vhal_files(output_dir)
         
         print(f"VHAL files generated successfully!")
@@ -114,6 +117,29 @@ def cleanup_intermediate_files(json_file: str, keep_json: bool = False):
         except OSError as e:
             print(f"Error cleaning up file {json_file}: {e}")
 
+def parse_shards(argv):
+    """Read the --shards=N option (number of per-signal code shards, default 1)"""
+    for arg in argv:
+        if arg.startswith("--shards="):
+            try:
+                return int(arg.split("=", 1)[1])
+            except ValueError:
+                print(f"Error: invalid shard count: {arg}")
+                sys.exit(1)
+    return 1
+
+def parse_can_databases(argv):
+    """Read the repeatable --can-dbc=<bus>:<file.dbc> option (CAN layouts for SocketCAN ingest)"""
+    databases = []
+    for arg in argv:
+        if arg.startswith("--can-dbc="):
+            bus, separator, dbc_file = arg.split("=", 1)[1].partition(":")
+            if not bus or not separator or not dbc_file:
+                print(f"Error: expected --can-dbc=<bus>:<file.dbc>, got {arg}")
+                sys.exit(1)
+            databases.append((bus, dbc_file))
+    return databases
+
 def main():
     """Main entry point"""
     print_banner()
@@ -121,7 +147,8 @@ def main():
     if len(sys.argv) < 2:
         print("\nError: No input file specified")
         print("\nUsage:")
-        print("   python main.py <vss_file>")
+        print("   python main.py <vss_file> [--keep-json] [--per-signal-converters] [--shards=N]"
+              " [--can-dbc=<bus>:<file.dbc>]...")
         print("\nExample:")
         print("   python main.py data/input/VehicleSignalSpecification.vspec")
         sys.exit(1)
@@ -133,6 +160,9 @@ def main():
     templates_dir = os.path.join(os.path.dirname(__file__), "generator/templates")
     
     keep_json = "--keep-json" in sys.argv
+    per_signal_converters = "--per-signal-converters" in sys.argv
+    shards = parse_shards(sys.argv)
+    can_databases = parse_can_databases(sys.argv)
     
     print(f"Input VSS file: {vss_file}")
     print(f"Output VHAL directory: {vhal_output_dir}")
@@ -142,7 +172,9 @@ def main():
         vss_to_json(vss_file, json_output_file, config_dir)
         
         # Step 2: JSON to VHAL
-        json_to_vhal(json_output_file, vhal_output_dir, templates_dir)
+        json_to_vhal(json_output_file, vhal_output_dir, templates_dir,
+                     per_signal_converters=per_signal_converters, shards=shards,
+                     can_databases=can_databases)
         
         # Cleanup intermediate files
         if not keep_json:
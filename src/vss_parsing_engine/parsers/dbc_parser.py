@@ -0,0 +1,67 @@
+# vss_parsing_engine/parsers/dbc_parser.py
+
+import re
+from typing import Dict, List, Any
+
+# BO_ <id> <name>: <length> <transmitter>
+_MESSAGE_RE = re.compile(r'^BO_\s+(\d+)\s+(\w+)\s*:\s*(\d+)')
+# SG_ <name> [M|m<n>] : <start>|<length>@<order><sign> (<factor>,<offset>) [<min>|<max>] ...
+_SIGNAL_RE = re.compile(
+    r'^SG_\s+(\w+)\s*(\S+)?\s*:\s*(\d+)\|(\d+)@([01])([+-])\s*'
+    r'\(\s*([^,\s]+)\s*,\s*([^)\s]+)\s*\)')
+
+# Frame ID bit DBC files use for 29-bit identifiers; the same bit as CAN_EFF_FLAG
+CAN_EXTENDED_FLAG = 0x80000000
+
+
+class DBCParser:
+    """
+    Reads the message and signal layout of a CAN database (.dbc) file.
+
+    Only what a decoder needs is read: frame IDs, frame lengths and each
+    signal's bit position, byte order, signedness, factor and offset.
+    Multiplexed signals are reported as such so callers can skip them.
+    """
+
+    def __init__(self, dbc_file: str):
+        self.dbc_file = dbc_file
+
+    def load_messages(self) -> List[Dict[str, Any]]:
+        """
+        Parse the file.
+        Returns:
+            One dict per BO_ entry with 'id' (including CAN_EXTENDED_FLAG for
+            29-bit IDs), 'name', 'length' and 'signals', a list of dicts with
+            'name', 'start_bit', 'length', 'little_endian', 'signed',
+            'factor', 'offset' and 'multiplexed'.
+        """
+        messages = []
+        current = None
+        with open(self.dbc_file, 'r', encoding='utf-8', errors='replace') as f:
+            for line_number, raw_line in enumerate(f, 1):
+                line = raw_line.strip()
+                match = _MESSAGE_RE.match(line)
+                if match:
+                    current = {'id': int(match.group(1)), 'name': match.group(2),
+                               'length': int(match.group(3)), 'signals': []}
+                    messages.append(current)
+                    continue
+                if not line.startswith('SG_'):
+                    # Signals belong to the message directly above them
+                    if line:
+                        current = None
+                    continue
+                match = _SIGNAL_RE.match(line)
+                if not match or current is None:
+                    raise ValueError(f"{self.dbc_file}:{line_number}: unsupported signal line")
+                current['signals'].append({
+                    'name': match.group(1),
+                    'multiplexed': match.group(2) is not None,
+                    'start_bit': int(match.group(3)),
+                    'length': int(match.group(4)),
+                    'little_endian': match.group(5) == '1',
+                    'signed': match.group(6) == '-',
+                    'factor': float(match.group(7)),
+                    'offset': float(match.group(8)),
+                })
+        return messages